@@ -0,0 +1,139 @@
+// Frame time of several heavy, independent ImGui panels built in parallel on
+// a work-stealing pool (see parallel_frames.h), for an increasing number of
+// threads.
+//
+// Usage: bench_panels [--panels N] [--frames N] [--max-threads N]
+
+#include "imgui.h"
+#include "parallel_frames.h"
+#include "work_stealing_pool.h"
+#include <FL/Fl.H>
+#include <FL/Fl_Double_Window.H>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+// Per-panel state, so that builds running concurrently share nothing
+struct HeavyPanel {
+    int id;
+    int frame;
+    float values[2000];
+    bool checks[64];
+};
+
+static void BuildHeavyPanel(HeavyPanel &p) {
+    p.frame++;
+    for (int i = 0; i < IM_ARRAYSIZE(p.values); i++)
+        p.values[i] = sinf((float)(i + p.frame) * 0.01f * (float)(p.id + 1));
+
+    ImGuiIO &io = ImGui::GetIO();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(io.DisplaySize);
+    ImGui::Begin("Panel", nullptr, ImGuiWindowFlags_NoDecoration);
+    ImGui::Text("Panel %d, frame %d", p.id, p.frame);
+    ImGui::PlotLines("signal", p.values, IM_ARRAYSIZE(p.values), 0, nullptr,
+                     -1.0f, 1.0f, ImVec2(0, 80));
+    for (int i = 0; i < IM_ARRAYSIZE(p.checks); i++) {
+        ImGui::PushID(i);
+        ImGui::Checkbox("##check", &p.checks[i]);
+        ImGui::PopID();
+        if (i % 16 != 15)
+            ImGui::SameLine();
+    }
+    // No clipper on purpose: every row is submitted, like a busy dashboard
+    if (ImGui::BeginTable("rows", 6,
+                          ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                              ImGuiTableFlags_ScrollY)) {
+        for (int row = 0; row < 300; row++) {
+            for (int col = 0; col < 6; col++) {
+                ImGui::TableNextColumn();
+                ImGui::Text("%d:%d %.4f", row, col,
+                            p.values[(row * 6 + col) % IM_ARRAYSIZE(p.values)]);
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+static int IntArg(int argc, char **argv, const char *name, int def) {
+    for (int i = 1; i + 1 < argc; i++)
+        if (strcmp(argv[i], name) == 0)
+            return atoi(argv[i + 1]);
+    return def;
+}
+
+int main(int argc, char **argv) {
+    const char *glsl_version = "#version 130";
+    int panel_count = IntArg(argc, argv, "--panels", 8);
+    int frames = IntArg(argc, argv, "--frames", 200);
+    int max_threads = IntArg(argc, argv, "--max-threads",
+                             (int)std::thread::hardware_concurrency());
+    if (panel_count < 1 || frames < 1)
+        return 1;
+    if (max_threads < 1)
+        max_threads = 1;
+
+    const int cols = 4, pw = 320, ph = 360;
+    int rows = (panel_count + cols - 1) / cols;
+    Fl_Double_Window *win =
+        new Fl_Double_Window(cols * pw, rows * ph, "fltk-imgui panels bench");
+    std::vector<PanelWindow *> panels;
+    std::vector<HeavyPanel> state(panel_count);
+    for (int i = 0; i < panel_count; i++) {
+        PanelWindow *panel = new PanelWindow((i % cols) * pw, (i / cols) * ph,
+                                             pw - 2, ph - 2);
+        panel->mode(FL_OPENGL3);
+        panel->end();
+        panels.push_back(panel);
+    }
+    win->end();
+    win->show();
+    for (int i = 0; i < panel_count; i++) {
+        HeavyPanel *p = &state[i];
+        p->id = i;
+        panels[i]->init(glsl_version);
+        panels[i]->swap_interval(0); // measure the work, not vsync
+        panels[i]->build = [p] { BuildHeavyPanel(*p); };
+    }
+
+    printf("%d panels, %d frames per run\n", panel_count, frames);
+    printf("threads  frame ms  build ms  submit ms  speedup\n");
+    std::vector<int> thread_counts;
+    for (int n = 1; n < max_threads; n *= 2)
+        thread_counts.push_back(n);
+    thread_counts.push_back(max_threads);
+
+    double base = 0.0;
+    for (int threads : thread_counts) {
+        WorkStealingPool pool(threads);
+        PanelFrameTimings sum = {0, 0, 0}, t;
+        // Warm up: font atlases, GL objects, table layouts
+        for (int i = 0; i < 20 && Fl::check(); i++)
+            RenderPanels(pool, panels.data(), panel_count);
+        int done = 0;
+        for (; done < frames && Fl::check(); done++) {
+            RenderPanels(pool, panels.data(), panel_count, &t);
+            sum.prepare_ms += t.prepare_ms;
+            sum.build_ms += t.build_ms;
+            sum.submit_ms += t.submit_ms;
+        }
+        if (done == 0)
+            break;
+        double frame = (sum.prepare_ms + sum.build_ms + sum.submit_ms) / done;
+        if (threads == 1)
+            base = frame;
+        printf("%7d  %8.3f  %8.3f  %9.3f  %6.2fx\n", threads, frame,
+               sum.build_ms / done, sum.submit_ms / done, base / frame);
+        fflush(stdout);
+    }
+
+    for (PanelWindow *panel : panels)
+        panel->shutdown();
+    // deleting the window will also delete the panels
+    delete win;
+    return 0;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+// Dear ImGui user config, injected with IMGUI_USER_CONFIG by CMakeLists.txt.
+
+// Make the current context per-thread, so that independent contexts can build
+// their frames concurrently on worker threads (see parallel_frames.h). The
+// variable itself lives in imgui_impl_fltk.cpp.
+struct ImGuiContext;
+extern thread_local ImGuiContext *ImGui_ImplFltk_TlsContext;
+#define GImGui ImGui_ImplFltk_TlsContext
+#define IMGUI_IMPL_FLTK_THREAD_LOCAL_CONTEXT
@@ -1,6 +1,7 @@
 #include "imgui.h"
 #ifndef IMGUI_DISABLE
 #include "imgui_impl_fltk.h"
+#include "imgui_internal.h" // See ImGui_ImplFltk_CompactWindowBuffers()
 
 // Clang warnings with -Weverything
 #if defined(__clang__)
@@ -14,9 +15,52 @@
 #include <FL/Enumerations.H>
 #include <FL/Fl.H>
 #include <FL/Fl_Gl_Window.H>
+#include <FL/Fl_Group.H>
 #include <FL/Fl_Input.H>
+#include <mutex>
 #include <stdint.h>
 
+#ifdef IMGUI_IMPL_FLTK_THREAD_LOCAL_CONTEXT
+thread_local ImGuiContext *ImGui_ImplFltk_TlsContext = nullptr;
+#endif
+
+// A FLTK event as seen by Fl::event_*() at dispatch time, so that it can be
+// replayed into ImGui later and from another thread.
+struct ImGui_ImplFltk_Event {
+    int Type;
+    float X, Y; // Mouse position, or wheel delta for FL_MOUSEWHEEL
+    int Button; // ImGui mouse button for FL_PUSH/FL_RELEASE
+    int Key;
+    int State;
+    int TextOffset; // Into ImGui_ImplFltk_EventQueue::Text, or -1
+};
+
+// Per-window input queue used when frames are built off the FLTK thread.
+struct ImGui_ImplFltk_EventQueue {
+    std::mutex Mutex;
+    ImVector<ImGui_ImplFltk_Event> Events;
+    ImVector<char> Text;
+    ImVector<ImGui_ImplFltk_Event> DrainEvents; // Only touched by NewFrame
+    ImVector<char> DrainText;
+
+    // Clipboard, exchanged with FLTK on its own thread: the paste buffer is
+    // refreshed when a paste shortcut is queued, copies are flushed by
+    // ImGui_ImplFltk_SyncWindow().
+    ImVector<char> PasteText;
+    ImVector<char> PasteTextCopy; // Returned to ImGui, frame thread only
+    ImVector<char> CopyText;
+    bool CopyPending;
+
+    ImGui_ImplFltk_EventQueue() : CopyPending(false) {
+    }
+};
+
+static void ImGui_ImplFltk_SetText(ImVector<char> &buf, const char *text) {
+    int len = (int)strlen(text) + 1;
+    buf.resize(len);
+    memcpy(buf.Data, text, (size_t)len);
+}
+
 // FLTK Data
 struct ImGui_ImplFltk_Data {
     Fl_Gl_Window *Window;
@@ -25,10 +69,27 @@ struct ImGui_ImplFltk_Data {
     int MouseButtonsDown;
     Fl_Cursor MouseCursors[ImGuiMouseCursor_COUNT];
     Fl_Cursor LastMouseCursor;
+    Fl_Cursor PendingMouseCursor;
     int PendingMouseLeaveFrame;
     char *ClipboardTextData;
     bool MouseCanUseGlobalState;
 
+    // Event queueing (see ImGui_ImplFltk_SetEventQueueing()). While a queue
+    // is set, the window geometry below is sampled by ImGui_ImplFltk_SyncWindow
+    // instead of being read from the window in NewFrame.
+    ImGui_ImplFltk_EventQueue *Queue;
+    int WindowW, WindowH;
+    int PixelW, PixelH;
+
+    // Visibility, tracked from FL_SHOW/FL_HIDE on the FLTK thread (see
+    // ImGui_ImplFltk_SetHiddenPolicy())
+    bool Hidden;
+    Fl_Timestamp HiddenSince;
+    float HiddenFrameRate;
+    float ReleaseBuffersDelay;
+    bool BuffersReleased;  // ImGui buffers compacted, until the next frame
+    bool RendererReleased; // Renderer told to release, until FL_SHOW
+
     ImGui_ImplFltk_Data() {
         memset((void *)this, 0, sizeof(*this));
     }
@@ -38,10 +99,12 @@ struct ImGui_ImplFltk_Data {
 // multiple Dear ImGui contexts It is STRONGLY preferred that you use docking
 // branch with multi-viewports (== single Dear ImGui context + multiple windows)
 // instead of multiple Dear ImGui contexts.
-// FIXME: multi-context support is not well tested and probably dysfunctional in
-// this backend.
-// FIXME: some shared resources (mouse cursor shape, gamepad) are mishandled
-// when using multi-context.
+// One context per Fl_Gl_Window is supported: input queues, cursors and
+// visibility are per context, and with event queueing (see
+// parallel_frames.h) contexts can build their frames on different threads.
+// The caller must make the window's context current before
+// ImGui_ImplFltk_ProcessEvent(), as PanelWindow::handle() does.
+// FIXME: gamepads are not supported.
 static ImGui_ImplFltk_Data *ImGui_ImplFltk_GetBackendData() {
     return ImGui::GetCurrentContext()
                ? (ImGui_ImplFltk_Data *)ImGui::GetIO().BackendPlatformUserData
@@ -49,15 +112,41 @@ static ImGui_ImplFltk_Data *ImGui_ImplFltk_GetBackendData() {
 }
 
 // Functions
+
+// The hidden input receiving pastes, created on the first paste rather than
+// at init to keep it off the startup path.
+static Fl_Input *ImGui_ImplFltk_GetPasteInput(ImGui_ImplFltk_Data *bd) {
+    if (!bd->Input) {
+        Fl_Group *group = Fl_Group::current();
+        Fl_Group::current(nullptr);
+        bd->Input = new Fl_Input(0, 0, 0, 0);
+        Fl_Group::current(group);
+    }
+    return bd->Input;
+}
+
 static const char *ImGui_ImplFltk_GetClipboardText(void *) {
     ImGui_ImplFltk_Data *bd = ImGui_ImplFltk_GetBackendData();
-    Fl::paste(*bd->Input, 1);
-    bd->ClipboardTextData = (char *)bd->Input->value();
-    bd->Input->value("");
+    if (ImGui_ImplFltk_EventQueue *queue = bd->Queue) {
+        std::lock_guard<std::mutex> lock(queue->Mutex);
+        queue->PasteTextCopy = queue->PasteText;
+        return queue->PasteTextCopy.Size ? queue->PasteTextCopy.Data : "";
+    }
+    Fl_Input *input = ImGui_ImplFltk_GetPasteInput(bd);
+    Fl::paste(*input, 1);
+    bd->ClipboardTextData = (char *)input->value();
+    input->value("");
     return bd->ClipboardTextData;
 }
 
 static void ImGui_ImplFltk_SetClipboardText(void *, const char *text) {
+    ImGui_ImplFltk_Data *bd = ImGui_ImplFltk_GetBackendData();
+    if (ImGui_ImplFltk_EventQueue *queue = bd->Queue) {
+        std::lock_guard<std::mutex> lock(queue->Mutex);
+        ImGui_ImplFltk_SetText(queue->CopyText, text);
+        queue->CopyPending = true;
+        return;
+    }
     Fl::copy(text, strlen(text), 1);
 }
 
@@ -299,6 +388,116 @@ static void ImGui_ImplFltk_UpdateKeyModifiers(int key_mods) {
     io.AddKeyEvent(ImGuiMod_Super, (key_mods & FL_META) != 0);
 }
 
+static int ImGui_ImplFltk_MouseButton(int fltk_btn) {
+    if (fltk_btn == FL_LEFT_MOUSE)
+        return 0;
+    if (fltk_btn == FL_RIGHT_MOUSE)
+        return 1;
+    if (fltk_btn == FL_MIDDLE_MOUSE)
+        return 2;
+    return -1;
+}
+
+// Snapshot the state of the event being dispatched. Returns false for events
+// the backend doesn't handle.
+static bool ImGui_ImplFltk_CaptureEvent(int event, ImGui_ImplFltk_Event *e) {
+    memset((void *)e, 0, sizeof(*e));
+    e->Type = event;
+    e->TextOffset = -1;
+    switch (event) {
+    case FL_DRAG:
+    case FL_MOVE:
+        e->X = (float)Fl::event_x();
+        e->Y = (float)Fl::event_y();
+        return true;
+    case FL_MOUSEWHEEL:
+        e->X = -(float)Fl::event_dx();
+        e->Y = -(float)Fl::event_dy();
+        return true;
+    case FL_PUSH:
+    case FL_RELEASE:
+        e->Button = ImGui_ImplFltk_MouseButton(Fl::event_button());
+        return e->Button != -1;
+    case FL_KEYUP:
+    case FL_KEYDOWN:
+        e->Key = Fl::event_key();
+        e->State = Fl::event_state();
+        return true;
+    case FL_ENTER:
+    case FL_LEAVE:
+    case FL_FOCUS:
+    case FL_UNFOCUS:
+        return true;
+    }
+    return false;
+}
+
+static void ImGui_ImplFltk_ApplyEvent(const ImGui_ImplFltk_Event &e,
+                                      const char *text) {
+    ImGuiIO &io = ImGui::GetIO();
+    ImGui_ImplFltk_Data *bd = ImGui_ImplFltk_GetBackendData();
+
+    switch (e.Type) {
+    case FL_DRAG:
+    case FL_MOVE:
+        io.AddMouseSourceEvent(ImGuiMouseSource_Mouse);
+        io.AddMousePosEvent(e.X, e.Y);
+        break;
+    case FL_MOUSEWHEEL:
+        io.AddMouseSourceEvent(ImGuiMouseSource_Mouse);
+        io.AddMouseWheelEvent(e.X, e.Y);
+        break;
+    case FL_PUSH:
+    case FL_RELEASE:
+        io.AddMouseSourceEvent(ImGuiMouseSource_Mouse);
+        io.AddMouseButtonEvent(e.Button, (e.Type == FL_PUSH));
+        bd->MouseButtonsDown =
+            (e.Type == FL_PUSH) ? (bd->MouseButtonsDown | (1 << e.Button))
+                                : (bd->MouseButtonsDown & ~(1 << e.Button));
+        break;
+    case FL_KEYUP:
+        ImGui_ImplFltk_UpdateKeyModifiers(e.State);
+        io.AddKeyEvent(ImGui_ImplFltk_KeycodeToImGuiKey(e.Key),
+                       (e.Type == FL_KEYUP));
+        break;
+    case FL_KEYDOWN:
+        if (text)
+            io.AddInputCharactersUTF8(text);
+        ImGui_ImplFltk_UpdateKeyModifiers(e.State);
+        io.AddKeyEvent(ImGui_ImplFltk_KeycodeToImGuiKey(e.Key),
+                       (e.Type == FL_KEYDOWN));
+        break;
+    case FL_ENTER:
+        bd->PendingMouseLeaveFrame = 0;
+        break;
+    case FL_LEAVE:
+        bd->PendingMouseLeaveFrame = ImGui::GetFrameCount() + 1;
+        break;
+    case FL_FOCUS:
+        io.AddFocusEvent(true);
+        break;
+    case FL_UNFOCUS:
+        io.AddFocusEvent(false);
+        break;
+    }
+}
+
+// Replay queued events into ImGui. Called from NewFrame, on whichever thread
+// builds the frame.
+static void ImGui_ImplFltk_DrainEvents(ImGui_ImplFltk_EventQueue *queue) {
+    {
+        std::lock_guard<std::mutex> lock(queue->Mutex);
+        queue->DrainEvents.swap(queue->Events);
+        queue->DrainText.swap(queue->Text);
+    }
+    for (const ImGui_ImplFltk_Event &e : queue->DrainEvents)
+        ImGui_ImplFltk_ApplyEvent(e, e.TextOffset >= 0
+                                         ? &queue->DrainText[e.TextOffset]
+                                         : nullptr);
+    queue->DrainEvents.resize(0);
+    queue->DrainText.resize(0);
+}
+
 // You can read the io.WantCaptureMouse, io.WantCaptureKeyboard flags to tell if
 // dear imgui wants to use your inputs.
 // - When io.WantCaptureMouse is true, do not dispatch mouse input data to your
@@ -310,83 +509,58 @@ static void ImGui_ImplFltk_UpdateKeyModifiers(int key_mods) {
 // and some of them are not meant to be used by dear imgui, you may need to
 // filter events based on their windowID field.
 bool ImGui_ImplFltk_ProcessEvent(int event) {
-    ImGuiIO &io = ImGui::GetIO();
     ImGui_ImplFltk_Data *bd = ImGui_ImplFltk_GetBackendData();
-
-    switch (event) {
-    case FL_DRAG:
-    case FL_MOVE: {
-        ImVec2 mouse_pos((float)Fl::event_x(), (float)Fl::event_y());
-        io.AddMouseSourceEvent(ImGuiMouseSource_Mouse);
-        io.AddMousePosEvent(mouse_pos.x, mouse_pos.y);
-        return true;
+    // FL_SHOW/FL_HIDE also come while the window is shown before Init() and
+    // deleted after Shutdown()
+    if (bd == nullptr)
+        return false;
+
+    // Hiding and iconifying only change what the application loop does, so
+    // they are tracked here rather than queued, and left to FLTK
+    if (event == FL_HIDE || event == FL_SHOW) {
+        bool hidden = event == FL_HIDE;
+        if (hidden && !bd->Hidden)
+            bd->HiddenSince = Fl::now();
+        if (!hidden)
+            bd->BuffersReleased = bd->RendererReleased = false;
+        bd->Hidden = hidden;
+        return false;
     }
-    case FL_MOUSEWHEEL: {
 
-        float wheel_x = -(float)Fl::event_dx();
-        float wheel_y = -(float)Fl::event_dy();
-        io.AddMouseSourceEvent(ImGuiMouseSource_Mouse);
-        io.AddMouseWheelEvent(wheel_x, wheel_y);
-        return true;
-    }
-    case FL_PUSH:
-    case FL_RELEASE: {
-        auto fltk_btn = Fl::event_button();
-        int mouse_button = -1;
-        if (fltk_btn == FL_LEFT_MOUSE) {
-            mouse_button = 0;
+    ImGui_ImplFltk_Event e;
+    if (!ImGui_ImplFltk_CaptureEvent(event, &e))
+        return false;
+
+    const char *text = event == FL_KEYDOWN ? Fl::event_text() : nullptr;
+    if (bd->Queue) {
+        ImGui_ImplFltk_EventQueue *queue = bd->Queue;
+        // The frame thread can't ask FLTK for the clipboard, so grab it now
+        // if this key is about to paste
+        bool paste = event == FL_KEYDOWN &&
+                     (((e.State & (FL_CTRL | FL_META)) && e.Key == 'v') ||
+                      ((e.State & FL_SHIFT) && e.Key == FL_Insert));
+        if (paste) {
+            Fl_Input *input = ImGui_ImplFltk_GetPasteInput(bd);
+            Fl::paste(*input, 1);
+            std::lock_guard<std::mutex> lock(queue->Mutex);
+            ImGui_ImplFltk_SetText(queue->PasteText, input->value());
+            input->value("");
         }
-        if (fltk_btn == FL_RIGHT_MOUSE) {
-            mouse_button = 1;
+        std::lock_guard<std::mutex> lock(queue->Mutex);
+        if (text) {
+            e.TextOffset = queue->Text.Size;
+            size_t len = strlen(text) + 1;
+            queue->Text.resize(queue->Text.Size + (int)len);
+            memcpy(&queue->Text[e.TextOffset], text, len);
         }
-        if (fltk_btn == FL_MIDDLE_MOUSE) {
-            mouse_button = 2;
-        }
-        if (mouse_button == -1)
-            break;
-        io.AddMouseSourceEvent(ImGuiMouseSource_Mouse);
-        io.AddMouseButtonEvent(mouse_button, (event == FL_PUSH));
-        bd->MouseButtonsDown =
-            (event == FL_PUSH) ? (bd->MouseButtonsDown | (1 << mouse_button))
-                               : (bd->MouseButtonsDown & ~(1 << mouse_button));
-        return true;
+        queue->Events.push_back(e);
+    } else {
+        ImGui_ImplFltk_ApplyEvent(e, text);
     }
-    case FL_KEYUP: {
-        auto key = Fl::event_key();
-        ImGuiKey imkey = ImGui_ImplFltk_KeycodeToImGuiKey(key);
-        auto state = Fl::event_state();
-        ImGui_ImplFltk_UpdateKeyModifiers(state);
-        io.AddKeyEvent(imkey, (event == FL_KEYUP));
+
+    if (event == FL_KEYUP)
         bd->Window->handle(FL_UNFOCUS);
-        return true;
-    }
-    case FL_KEYDOWN: {
-        auto c = Fl::event_text();
-        if (c && event == FL_KEYDOWN)
-            io.AddInputCharactersUTF8(c);
-        ImGuiKey imkey = ImGui_ImplFltk_KeycodeToImGuiKey(Fl::event_key());
-        auto state = Fl::event_state();
-        ImGui_ImplFltk_UpdateKeyModifiers(state);
-        io.AddKeyEvent(imkey, (event == FL_KEYDOWN));
-        return true;
-    }
-    case FL_ENTER:
-    case FL_LEAVE:
-    case FL_FOCUS:
-    case FL_UNFOCUS: {
-        if (event == FL_ENTER) {
-            bd->PendingMouseLeaveFrame = 0;
-        }
-        if (event == FL_LEAVE)
-            bd->PendingMouseLeaveFrame = ImGui::GetFrameCount() + 1;
-        if (event == FL_FOCUS)
-            io.AddFocusEvent(true);
-        else if (event == FL_UNFOCUS)
-            io.AddFocusEvent(false);
-        return true;
-    }
-    }
-    return false;
+    return true;
 }
 
 static bool ImGui_ImplFltk_Init(Fl_Gl_Window *window) {
@@ -408,9 +582,11 @@ static bool ImGui_ImplFltk_Init(Fl_Gl_Window *window) {
                                           // requests (optional, rarely used)
 
     bd->Window = window;
-    bd->Input = new Fl_Input(0, 0, 0, 0);
     bd->Time = Fl::now();
     bd->MouseCanUseGlobalState = mouse_can_use_global_state;
+    bd->Hidden = !window->visible_r();
+    bd->HiddenSince = bd->Time;
+    bd->ReleaseBuffersDelay = -1.0f;
 
     io.SetClipboardTextFn = ImGui_ImplFltk_SetClipboardText;
     io.GetClipboardTextFn = ImGui_ImplFltk_GetClipboardText;
@@ -451,6 +627,8 @@ void ImGui_ImplFltk_Shutdown() {
     ImGuiIO &io = ImGui::GetIO();
 
     bd->LastMouseCursor = FL_CURSOR_ARROW;
+    if (bd->Queue)
+        IM_DELETE(bd->Queue);
 
     io.BackendPlatformName = nullptr;
     io.BackendPlatformUserData = nullptr;
@@ -460,6 +638,14 @@ void ImGui_ImplFltk_Shutdown() {
     IM_DELETE(bd);
 }
 
+static void ImGui_ImplFltk_SetMouseCursor(Fl_Cursor cursor) {
+    ImGui_ImplFltk_Data *bd = ImGui_ImplFltk_GetBackendData();
+    if (bd->Queue)
+        bd->PendingMouseCursor = cursor; // Applied by ImGui_ImplFltk_SyncWindow
+    else
+        bd->Window->cursor(cursor);
+}
+
 static void ImGui_ImplFltk_UpdateMouseCursor() {
     ImGuiIO &io = ImGui::GetIO();
     if (io.ConfigFlags & ImGuiConfigFlags_NoMouseCursorChange)
@@ -469,7 +655,7 @@ static void ImGui_ImplFltk_UpdateMouseCursor() {
     ImGuiMouseCursor imgui_cursor = ImGui::GetMouseCursor();
     if (io.MouseDrawCursor || imgui_cursor == ImGuiMouseCursor_None) {
         // Hide OS mouse cursor if imgui is drawing it or if it wants no cursor
-        bd->Window->cursor(FL_CURSOR_NONE);
+        ImGui_ImplFltk_SetMouseCursor(FL_CURSOR_NONE);
     } else {
         // Show OS mouse cursor
         Fl_Cursor expected_cursor =
@@ -477,7 +663,7 @@ static void ImGui_ImplFltk_UpdateMouseCursor() {
                 ? bd->MouseCursors[imgui_cursor]
                 : bd->MouseCursors[ImGuiMouseCursor_Arrow];
         if (bd->LastMouseCursor != expected_cursor) {
-            bd->Window->cursor(expected_cursor);
+            ImGui_ImplFltk_SetMouseCursor(expected_cursor);
             bd->LastMouseCursor = expected_cursor;
         }
     }
@@ -488,9 +674,16 @@ void ImGui_ImplFltk_NewFrame() {
     IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplFltk_Init()?");
     ImGuiIO &io = ImGui::GetIO();
 
+    if (bd->Queue)
+        ImGui_ImplFltk_DrainEvents(bd->Queue);
+
     // Setup display size (every frame to accommodate for window resizing)
-    int w = bd->Window->w(), h = bd->Window->h();
-    int display_w = bd->Window->pixel_w(), display_h = bd->Window->pixel_h();
+    int w = bd->WindowW, h = bd->WindowH;
+    int display_w = bd->PixelW, display_h = bd->PixelH;
+    if (!bd->Queue) {
+        w = bd->Window->w(), h = bd->Window->h();
+        display_w = bd->Window->pixel_w(), display_h = bd->Window->pixel_h();
+    }
     io.DisplaySize = ImVec2((float)w, (float)h);
     if (w > 0 && h > 0)
         io.DisplayFramebufferScale =
@@ -500,6 +693,8 @@ void ImGui_ImplFltk_NewFrame() {
     auto delta = (float)Fl::seconds_between(current_time, bd->Time);
     io.DeltaTime = bd->Time.sec > 0.0 ? delta : (float)(1.0f / 60.0f);
     bd->Time = current_time;
+    // Begin() reallocates compacted buffers, including on keep-alive frames
+    bd->BuffersReleased = false;
 
     if (bd->PendingMouseLeaveFrame &&
         bd->PendingMouseLeaveFrame >= ImGui::GetFrameCount() &&
@@ -511,6 +706,110 @@ void ImGui_ImplFltk_NewFrame() {
     ImGui_ImplFltk_UpdateMouseCursor();
 }
 
+void ImGui_ImplFltk_SetEventQueueing(bool enabled) {
+    ImGui_ImplFltk_Data *bd = ImGui_ImplFltk_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplFltk_Init()?");
+    if (enabled && !bd->Queue) {
+        bd->Queue = IM_NEW(ImGui_ImplFltk_EventQueue)();
+        ImGui_ImplFltk_SyncWindow();
+    } else if (!enabled && bd->Queue) {
+        ImGui_ImplFltk_DrainEvents(bd->Queue);
+        IM_DELETE(bd->Queue);
+        bd->Queue = nullptr;
+    }
+}
+
+void ImGui_ImplFltk_SyncWindow() {
+    ImGui_ImplFltk_Data *bd = ImGui_ImplFltk_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplFltk_Init()?");
+    ImGui_ImplFltk_EventQueue *queue = bd->Queue;
+    if (!queue)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(queue->Mutex);
+        if (queue->CopyPending)
+            Fl::copy(queue->CopyText.Data, queue->CopyText.Size - 1, 1);
+        queue->CopyPending = false;
+    }
+    if (bd->PendingMouseCursor != FL_CURSOR_DEFAULT)
+        bd->Window->cursor(bd->PendingMouseCursor);
+    bd->PendingMouseCursor = FL_CURSOR_DEFAULT;
+    bd->WindowW = bd->Window->w();
+    bd->WindowH = bd->Window->h();
+    bd->PixelW = bd->Window->pixel_w();
+    bd->PixelH = bd->Window->pixel_h();
+}
+
+void ImGui_ImplFltk_SetHiddenPolicy(float keep_alive_fps,
+                                    float release_buffers_delay) {
+    ImGui_ImplFltk_Data *bd = ImGui_ImplFltk_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplFltk_Init()?");
+    bd->HiddenFrameRate = keep_alive_fps;
+    bd->ReleaseBuffersDelay = release_buffers_delay;
+}
+
+bool ImGui_ImplFltk_IsWindowHidden() {
+    ImGui_ImplFltk_Data *bd = ImGui_ImplFltk_GetBackendData();
+    return bd && bd->Hidden;
+}
+
+ImGui_ImplFltk_FrameMode ImGui_ImplFltk_GetFrameMode() {
+    ImGui_ImplFltk_Data *bd = ImGui_ImplFltk_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplFltk_Init()?");
+    if (!bd->Hidden)
+        return ImGui_ImplFltk_FrameMode_Render;
+    if (bd->HiddenFrameRate > 0.0f &&
+        Fl::seconds_since(bd->Time) >= 1.0 / bd->HiddenFrameRate)
+        return ImGui_ImplFltk_FrameMode_KeepAlive;
+    return ImGui_ImplFltk_FrameMode_Skip;
+}
+
+double ImGui_ImplFltk_GetHiddenWaitTime() {
+    ImGui_ImplFltk_Data *bd = ImGui_ImplFltk_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplFltk_Init()?");
+    if (!bd->Hidden)
+        return 0.0;
+    double wait = 1e20; // Until the next event, like Fl::wait()
+    if (bd->HiddenFrameRate > 0.0f)
+        wait = 1.0 / bd->HiddenFrameRate - Fl::seconds_since(bd->Time);
+    // Wake up for ReleaseIdleBuffers() too, nothing else may come to do it
+    if (bd->ReleaseBuffersDelay >= 0.0f && !bd->BuffersReleased) {
+        double release = bd->ReleaseBuffersDelay -
+                         Fl::seconds_since(bd->HiddenSince);
+        if (release < wait)
+            wait = release;
+    }
+    return wait > 0.0 ? wait : 0.0;
+}
+
+// The only use of imgui internals in this backend, checked against the tag
+// pinned in CMakeLists.txt. ImGui's own GC (io.ConfigMemoryCompactTimer) only
+// compacts windows that were inactive for a while and runs inside NewFrame(),
+// but a hidden window runs no frames and its windows were all active in the
+// last one. Compacting them between frames is safe: Begin() reallocates the
+// buffers of a compacted window.
+static void ImGui_ImplFltk_CompactWindowBuffers() {
+    ImGuiContext &g = *ImGui::GetCurrentContext();
+    for (ImGuiWindow *window : g.Windows)
+        if (!window->MemoryCompacted)
+            ImGui::GcCompactTransientWindowBuffers(window);
+}
+
+bool ImGui_ImplFltk_ReleaseIdleBuffers() {
+    ImGui_ImplFltk_Data *bd = ImGui_ImplFltk_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplFltk_Init()?");
+    if (!bd->Hidden || bd->BuffersReleased || bd->ReleaseBuffersDelay < 0.0f ||
+        Fl::seconds_since(bd->HiddenSince) < bd->ReleaseBuffersDelay)
+        return false;
+
+    ImGui_ImplFltk_CompactWindowBuffers();
+    bd->BuffersReleased = true;
+    if (bd->RendererReleased)
+        return false;
+    bd->RendererReleased = true;
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 
 #if defined(__clang__)
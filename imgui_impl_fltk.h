@@ -10,6 +10,43 @@ IMGUI_IMPL_API void ImGui_ImplFltk_Shutdown();
 IMGUI_IMPL_API void ImGui_ImplFltk_NewFrame();
 IMGUI_IMPL_API bool ImGui_ImplFltk_ProcessEvent(int);
 
+// Building frames off the FLTK thread (see parallel_frames.h). Once enabled,
+// ProcessEvent() only records events into a per-window queue that NewFrame()
+// drains, and NewFrame() no longer calls into FLTK. Call SyncWindow() on the
+// FLTK thread between frames (never while NewFrame()..Render() runs) to apply
+// the mouse cursor and sample the window size for the next frame.
+IMGUI_IMPL_API void ImGui_ImplFltk_SetEventQueueing(bool enabled);
+IMGUI_IMPL_API void ImGui_ImplFltk_SyncWindow();
+
+// Hidden and iconified windows. The backend tracks FL_HIDE/FL_SHOW, and the
+// application loop asks GetFrameMode() whether to build and render a frame:
+// - Render: the window is visible.
+// - KeepAlive: hidden, but a keep-alive frame is due. Build the frame for its
+//   logic, skip GL submission and swap, then call ReleaseIdleBuffers().
+// - Skip: hidden. Call ReleaseIdleBuffers(), then block in
+//   Fl::wait(GetHiddenWaitTime()), which returns when the next keep-alive
+//   frame or buffer release is due.
+// keep_alive_fps <= 0 (default) runs no frame at all while hidden.
+// ReleaseIdleBuffers() compacts the ImGui draw buffers once the window has
+// been hidden for release_buffers_delay seconds (< 0, the default: never).
+// Keep-alive frames grow them back, so it compacts again after each of them.
+// It returns true once per hidden period, so the renderer can drop its own
+// buffers, e.g. with ImGui_ImplOpenGL3_DestroyDeviceObjects(); keep-alive
+// frames don't touch GL, so those stay released. Everything is rebuilt by the
+// next frame after FL_SHOW.
+enum ImGui_ImplFltk_FrameMode {
+    ImGui_ImplFltk_FrameMode_Render,
+    ImGui_ImplFltk_FrameMode_KeepAlive,
+    ImGui_ImplFltk_FrameMode_Skip,
+};
+
+IMGUI_IMPL_API void ImGui_ImplFltk_SetHiddenPolicy(float keep_alive_fps,
+                                                   float release_buffers_delay);
+IMGUI_IMPL_API bool ImGui_ImplFltk_IsWindowHidden();
+IMGUI_IMPL_API ImGui_ImplFltk_FrameMode ImGui_ImplFltk_GetFrameMode();
+IMGUI_IMPL_API double ImGui_ImplFltk_GetHiddenWaitTime();
+IMGUI_IMPL_API bool ImGui_ImplFltk_ReleaseIdleBuffers();
+
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 static inline void ImGui_ImplFltk_NewFrame(Fl_Gl_Window *) {
     ImGui_ImplFltk_NewFrame();
@@ -11,12 +11,14 @@
 #include "imgui.h"
 #include "imgui_impl_fltk.h"
 #include "imgui_impl_opengl3.h"
+#include "startup_profiler.h"
 #include <FL/Fl.H>
 #include <FL/Fl_Double_Window.H>
 #include <FL/Fl_Gl_Window.H>
 #include <GL/gl.h>
 #include <chrono>
 #include <stdio.h>
+#include <string.h>
 #include <thread>
 
 #if defined(_MSC_VER) && (_MSC_VER >= 1900) &&                                 \
@@ -39,7 +41,24 @@ class GlWin : public Fl_Gl_Window {
 };
 
 // Main code
-int main(int, char **) {
+// --startup-report: print the timing of each startup step once the first
+//                   frame is on screen, and exit
+// --deferred-init:  clear the window as soon as it is exposed, before the
+//                   backends are initialized, and build the font atlas on a
+//                   worker thread while the shaders compile. With imgui 1.92
+//                   the atlas only bakes its base glyphs up front, so most of
+//                   the gain is the early first paint.
+int main(int argc, char **argv) {
+    StartupProfiler startup;
+    bool startup_report = false;
+    bool deferred_init = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--startup-report") == 0)
+            startup_report = true;
+        else if (strcmp(argv[i], "--deferred-init") == 0)
+            deferred_init = true;
+    }
+
     // GL 3.0 + GLSL 130
     const char *glsl_version = "#version 130";
     // Setup Dear ImGui context
@@ -49,6 +68,12 @@ int main(int, char **) {
     (void)io;
     io.ConfigFlags |=
         ImGuiConfigFlags_NavEnableKeyboard; // Enable Keyboard Controls
+    startup.mark("create context");
+
+    // Our state
+    bool show_demo_window = true;
+    bool show_another_window = false;
+    ImVec4 clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
 
     // Create window with graphics context
     Fl_Double_Window *win =
@@ -60,8 +85,25 @@ int main(int, char **) {
     glwin->end();
     win->end();
     win->show();
+    startup.mark("show window");
     glwin->make_current();
     glwin->swap_interval(1); // enable vsync
+    startup.mark("make current");
+
+    if (deferred_init) {
+        // Cheap first frame, so the window isn't blank while we initialize.
+        // show() doesn't wait for the map, and a swap before the first expose
+        // may never reach the screen.
+        glwin->wait_for_expose();
+        startup.mark("wait for expose");
+        glViewport(0, 0, glwin->pixel_w(), glwin->pixel_h());
+        glClearColor(clear_color.x * clear_color.w,
+                     clear_color.y * clear_color.w,
+                     clear_color.z * clear_color.w, clear_color.w);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glwin->swap_buffers();
+        startup.mark("first paint (clear)");
+    }
 
     // Setup Dear ImGui style
     ImGui::StyleColorsDark();
@@ -69,16 +111,59 @@ int main(int, char **) {
 
     // Setup Platform/Renderer backends
     ImGui_ImplFltk_InitForOpenGL(glwin);
+    startup.mark("platform backend init");
     ImGui_ImplOpenGL3_Init(glsl_version);
+    startup.mark("renderer backend init");
 
-    // Our state
-    bool show_demo_window = true;
-    bool show_another_window = false;
-    ImVec4 clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
+    // The atlas build reads the backend flags, so it starts only once the
+    // renderer has set them; it then overlaps the shader compile. Older
+    // renderers upload the atlas with their device objects, so it must be
+    // built before them: building it again afterwards would drop the texture.
+    std::thread atlas_thread;
+#if IMGUI_VERSION_NUM >= 19200
+    if (deferred_init) {
+        atlas_thread = std::thread([&io, &startup] {
+            double begin = startup.elapsed_ms();
+            io.Fonts->Build();
+            startup.add("font atlas (worker)", begin, startup.elapsed_ms());
+        });
+    }
+#endif
+    if (!atlas_thread.joinable()) {
+        io.Fonts->Build();
+        startup.mark("font atlas");
+    }
+    // Done by the first ImGui_ImplOpenGL3_NewFrame() otherwise
+    ImGui_ImplOpenGL3_CreateDeviceObjects();
+    startup.mark("compile shaders");
+    if (atlas_thread.joinable()) {
+        atlas_thread.join();
+        startup.mark("wait for font atlas");
+    }
+
+    // While the window is hidden or iconified, run no frames and give the
+    // draw buffers back after 30s
+    ImGui_ImplFltk_SetHiddenPolicy(0.0f, 30.0f);
+
+    for (;;) {
+        // While hidden, sleep until the window comes back (or until the next
+        // keep-alive frame is due)
+        if (ImGui_ImplFltk_IsWindowHidden())
+            Fl::wait(ImGui_ImplFltk_GetHiddenWaitTime());
+        else
+            Fl::wait();
+        if (!Fl::first_window())
+            break;
+        ImGui_ImplFltk_FrameMode frame_mode = ImGui_ImplFltk_GetFrameMode();
+        if (frame_mode == ImGui_ImplFltk_FrameMode_Skip) {
+            if (ImGui_ImplFltk_ReleaseIdleBuffers())
+                ImGui_ImplOpenGL3_DestroyDeviceObjects();
+            continue;
+        }
 
-    while (Fl::wait()) {
         // Start the Dear ImGui frame
-        ImGui_ImplOpenGL3_NewFrame();
+        if (frame_mode == ImGui_ImplFltk_FrameMode_Render)
+            ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplFltk_NewFrame();
         ImGui::NewFrame();
 
@@ -139,6 +224,12 @@ int main(int, char **) {
 
         // Rendering
         ImGui::Render();
+        if (frame_mode == ImGui_ImplFltk_FrameMode_KeepAlive) {
+            // Nothing to show while hidden; give back what the frame regrew
+            if (ImGui_ImplFltk_ReleaseIdleBuffers())
+                ImGui_ImplOpenGL3_DestroyDeviceObjects();
+            continue;
+        }
         int display_w = glwin->pixel_w(), display_h = glwin->pixel_h();
         glViewport(0, 0, display_w, display_h);
         glClearColor(clear_color.x * clear_color.w,
@@ -147,6 +238,12 @@ int main(int, char **) {
         glClear(GL_COLOR_BUFFER_BIT);
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
         glwin->swap_buffers();
+        if (startup_report) {
+            glFinish();
+            startup.mark("first frame");
+            startup.report(stdout);
+            break;
+        }
         // here we force a redraw at our own rate,
         // otherwise our app will only update when it detects an event
         win->redraw();
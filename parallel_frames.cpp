@@ -0,0 +1,135 @@
+#include "parallel_frames.h"
+#include "imgui_impl_fltk.h"
+#include "imgui_impl_opengl3.h"
+#include "work_stealing_pool.h"
+#include <GL/gl.h>
+#include <chrono>
+#include <vector>
+
+#ifndef IMGUI_IMPL_FLTK_THREAD_LOCAL_CONTEXT
+#error "Parallel frames need the per-thread context from imconfig_fltk.h"
+#endif
+
+typedef std::chrono::steady_clock Clock;
+
+static double ElapsedMs(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+PanelWindow::PanelWindow(int x, int y, int w, int h, const char *label)
+    : Fl_Gl_Window(x, y, w, h, label),
+      clear_color(0.45f, 0.55f, 0.60f, 1.00f), ctx_(nullptr) {
+}
+
+PanelWindow::~PanelWindow() {
+    shutdown();
+}
+
+void PanelWindow::init(const char *glsl_version) {
+    ImGuiContext *prev = ImGui::GetCurrentContext();
+    ctx_ = ImGui::CreateContext();
+    ImGui::SetCurrentContext(ctx_);
+    // Contexts saving imgui.ini from several worker threads would race
+    ImGui::GetIO().IniFilename = nullptr;
+
+    make_current();
+    ImGui_ImplFltk_InitForOpenGL(this);
+    ImGui_ImplFltk_SetEventQueueing(true);
+    ImGui_ImplOpenGL3_Init(glsl_version);
+    ImGui::SetCurrentContext(prev);
+}
+
+void PanelWindow::shutdown() {
+    if (!ctx_)
+        return;
+    ImGuiContext *prev = ImGui::GetCurrentContext();
+    make_current();
+    ImGui::SetCurrentContext(ctx_);
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui_ImplFltk_Shutdown();
+    ImGui::DestroyContext(ctx_);
+    ImGui::SetCurrentContext(prev != ctx_ ? prev : nullptr);
+    ctx_ = nullptr;
+}
+
+int PanelWindow::handle(int ev) {
+    int ret = Fl_Gl_Window::handle(ev);
+    if (!ctx_)
+        return ret;
+    ImGuiContext *prev = ImGui::GetCurrentContext();
+    ImGui::SetCurrentContext(ctx_);
+    ret |= ImGui_ImplFltk_ProcessEvent(ev);
+    ImGui::SetCurrentContext(prev);
+    return ret;
+}
+
+void RenderPanels(WorkStealingPool &pool, PanelWindow *const *panels,
+                  int count, PanelFrameTimings *timings) {
+    ImGuiContext *prev = ImGui::GetCurrentContext();
+    Clock::time_point t0 = Clock::now();
+
+    // Hidden panels are skipped (see ImGui_ImplFltk_SetHiddenPolicy()). The
+    // renderer may create GL objects on the first frame, or after a release.
+    std::vector<ImGui_ImplFltk_FrameMode> modes(count);
+    for (int i = 0; i < count; i++) {
+        ImGui::SetCurrentContext(panels[i]->context());
+        modes[i] = ImGui_ImplFltk_GetFrameMode();
+        if (modes[i] == ImGui_ImplFltk_FrameMode_Skip) {
+            if (ImGui_ImplFltk_ReleaseIdleBuffers()) {
+                panels[i]->make_current();
+                ImGui_ImplOpenGL3_DestroyDeviceObjects();
+            }
+        } else if (modes[i] == ImGui_ImplFltk_FrameMode_Render) {
+            panels[i]->make_current();
+            ImGui_ImplOpenGL3_NewFrame();
+        }
+    }
+    Clock::time_point t1 = Clock::now();
+
+    for (int i = 0; i < count; i++) {
+        PanelWindow *panel = panels[i];
+        if (modes[i] == ImGui_ImplFltk_FrameMode_Skip)
+            continue;
+        pool.submit([panel] {
+            ImGui::SetCurrentContext(panel->context());
+            ImGui_ImplFltk_NewFrame();
+            ImGui::NewFrame();
+            if (panel->build)
+                panel->build();
+            ImGui::Render();
+            ImGui::SetCurrentContext(nullptr);
+        });
+    }
+    pool.wait();
+    Clock::time_point t2 = Clock::now();
+
+    for (int i = 0; i < count; i++) {
+        PanelWindow *panel = panels[i];
+        if (modes[i] == ImGui_ImplFltk_FrameMode_Skip)
+            continue;
+        ImGui::SetCurrentContext(panel->context());
+        ImGui_ImplFltk_SyncWindow();
+        if (modes[i] == ImGui_ImplFltk_FrameMode_KeepAlive) {
+            if (ImGui_ImplFltk_ReleaseIdleBuffers()) {
+                panel->make_current();
+                ImGui_ImplOpenGL3_DestroyDeviceObjects();
+            }
+            continue;
+        }
+        panel->make_current();
+        const ImVec4 &c = panel->clear_color;
+        glViewport(0, 0, panel->pixel_w(), panel->pixel_h());
+        glClearColor(c.x * c.w, c.y * c.w, c.z * c.w, c.w);
+        glClear(GL_COLOR_BUFFER_BIT);
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        panel->swap_buffers();
+    }
+    Clock::time_point t3 = Clock::now();
+
+    ImGui::SetCurrentContext(prev);
+    if (timings) {
+        timings->prepare_ms = ElapsedMs(t0, t1);
+        timings->build_ms = ElapsedMs(t1, t2);
+        timings->submit_ms = ElapsedMs(t2, t3);
+    }
+}
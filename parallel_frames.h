@@ -0,0 +1,51 @@
+#pragma once
+
+#include "imgui.h"
+#include <FL/Fl_Gl_Window.H>
+#include <functional>
+
+class WorkStealingPool;
+
+// An Fl_Gl_Window with its own ImGui context, for processes hosting several
+// independent panels. Input is queued per window (see
+// ImGui_ImplFltk_SetEventQueueing()), so the frame can be built on any thread
+// while GL submission stays on the thread owning the window.
+class PanelWindow : public Fl_Gl_Window {
+  public:
+    PanelWindow(int x, int y, int w, int h, const char *label = nullptr);
+    ~PanelWindow() override;
+
+    // Creates the context and the FLTK/OpenGL3 backends. The window must be
+    // shown.
+    void init(const char *glsl_version);
+    // Tears down the backends and the context; also done by the destructor.
+    void shutdown();
+
+    ImGuiContext *context() const {
+        return ctx_;
+    }
+
+    int handle(int ev) override;
+
+    // Builds the UI, called between ImGui::NewFrame() and ImGui::Render() on a
+    // pool thread. It must not touch FLTK or GL, nor state shared with other
+    // panels (ImGui::ShowDemoWindow() for instance keeps static state).
+    std::function<void()> build;
+    ImVec4 clear_color;
+
+  private:
+    ImGuiContext *ctx_;
+};
+
+struct PanelFrameTimings {
+    double prepare_ms; // Renderer NewFrame, GL thread
+    double build_ms;   // NewFrame/build/Render, on the pool
+    double submit_ms;  // GL submission and swap, GL thread
+};
+
+// Runs one frame for every panel: the ImGui side of each frame is spread over
+// the pool, everything touching FLTK or GL happens on the calling thread,
+// which must be the one owning the windows.
+// Hidden panels follow their ImGui_ImplFltk_GetFrameMode().
+void RenderPanels(WorkStealingPool &pool, PanelWindow *const *panels,
+                  int count, PanelFrameTimings *timings = nullptr);
@@ -0,0 +1,34 @@
+#include "startup_profiler.h"
+
+StartupProfiler::StartupProfiler()
+    : start_(std::chrono::steady_clock::now()), last_ms_(0.0) {
+}
+
+double StartupProfiler::elapsed_ms() const {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start_)
+        .count();
+}
+
+void StartupProfiler::mark(const char *step) {
+    double now = elapsed_ms();
+    std::lock_guard<std::mutex> lock(mutex_);
+    steps_.push_back({step, last_ms_, now, false});
+    last_ms_ = now;
+}
+
+void StartupProfiler::add(const char *step, double begin_ms, double end_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    steps_.push_back({step, begin_ms, end_ms, true});
+}
+
+void StartupProfiler::report(FILE *out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fprintf(out, "%-32s %10s %10s\n", "startup step", "ms", "done at");
+    for (const Step &s : steps_)
+        fprintf(out, "%-30s%s %10.3f %10.3f\n", s.name,
+                s.concurrent ? " *" : "  ", s.end_ms - s.begin_ms, s.end_ms);
+    fprintf(out, "time to first frame: %.3f ms (* ran concurrently)\n",
+            last_ms_);
+    fflush(out);
+}
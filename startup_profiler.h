@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+#include <vector>
+
+// Wall-clock timings of the startup steps, measured from construction (the
+// top of main()). Steps on the main thread are consecutive: mark() ends the
+// current one. Work running concurrently on other threads is recorded with
+// add(), from any thread.
+class StartupProfiler {
+  public:
+    StartupProfiler();
+
+    // Milliseconds since construction.
+    double elapsed_ms() const;
+
+    void mark(const char *step);
+    void add(const char *step, double begin_ms, double end_ms);
+
+    // Prints every step and the time of the last main-thread mark, which is
+    // the time to first frame when that mark ends the first frame.
+    void report(FILE *out) const;
+
+  private:
+    struct Step {
+        const char *name;
+        double begin_ms, end_ms;
+        bool concurrent;
+    };
+
+    std::chrono::steady_clock::time_point start_;
+    double last_ms_;
+    mutable std::mutex mutex_;
+    std::vector<Step> steps_;
+};
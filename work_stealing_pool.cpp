@@ -0,0 +1,88 @@
+#include "work_stealing_pool.h"
+
+WorkStealingPool::WorkStealingPool(int threads)
+    : queued_(0), pending_(0), next_(0), stop_(false) {
+    if (threads <= 0)
+        threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0)
+        threads = 1;
+    for (int i = 0; i < threads; i++)
+        queues_.emplace_back(new Queue);
+    for (int i = 1; i < threads; i++)
+        threads_.emplace_back(&WorkStealingPool::worker, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &t : threads_)
+        t.join();
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    Queue &q = *queues_[next_++ % queues_.size()];
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.push_back(std::move(task));
+    }
+    pending_++;
+    queued_++;
+    // Taking the lock orders the notification after any sleeper's predicate
+    // check, so the wakeup can't be lost.
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+    }
+    cv_.notify_all();
+}
+
+bool WorkStealingPool::try_run(int slot) {
+    std::function<void()> task;
+    int n = (int)queues_.size();
+    for (int i = 0; i < n && !task; i++) {
+        Queue &q = *queues_[(slot + i) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty())
+            continue;
+        if (i == 0) {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+        } else {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+        }
+    }
+    if (!task)
+        return false;
+    queued_--;
+    task();
+    if (--pending_ == 0) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+        }
+        cv_.notify_all();
+    }
+    return true;
+}
+
+void WorkStealingPool::worker(int slot) {
+    for (;;) {
+        if (try_run(slot))
+            continue;
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return stop_ || queued_ > 0; });
+        if (stop_ && queued_ == 0)
+            return;
+    }
+}
+
+void WorkStealingPool::wait() {
+    while (pending_ > 0) {
+        if (try_run(0))
+            continue;
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return pending_ == 0 || queued_ > 0; });
+    }
+}
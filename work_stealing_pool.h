@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small work-stealing thread pool. Every thread owns a deque: it pops its own
+// tasks from the back and steals from the front of the others when it runs
+// dry. The thread calling wait() takes part as slot 0, so a pool of size 1
+// runs everything serially on the caller.
+class WorkStealingPool {
+  public:
+    // threads <= 0 uses std::thread::hardware_concurrency().
+    explicit WorkStealingPool(int threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    int size() const {
+        return (int)queues_.size();
+    }
+
+    void submit(std::function<void()> task);
+    // Runs queued tasks on the calling thread until every submitted task has
+    // completed.
+    void wait();
+
+  private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    bool try_run(int slot);
+    void worker(int slot);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic<int> queued_;
+    std::atomic<int> pending_;
+    unsigned next_;
+    bool stop_;
+};